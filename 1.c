@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 // estrutura para armazenar os dados do usuário
 typedef struct Usuario {
@@ -9,21 +10,57 @@ typedef struct Usuario {
     char email[100];
 } Usuario;
 
+// índice de um nó no vetor de nós (32 bits no lugar de um ponteiro de 64); 0 representa NULL
+typedef uint32_t Indice;
+#define NULO 0u
+
+// cada ligação usa 29 bits para o índice e 3 bits para metade da altura do nó;
+// 6 bits de altura bastam, pois uma AVL com 2^29 nós nunca passa de altura 42
+#define BITS_INDICE 29
+#define MASCARA_INDICE ((1u << BITS_INDICE) - 1)
+#define MAX_NOS (1u << BITS_INDICE)
+
 // estrutura do nó da árvore AVL
 typedef struct NO {
     Usuario usuario;
-    int altura;
-    struct NO *esq;
-    struct NO *dir;
+    uint32_t esq;  // índice do filho esquerdo + 3 bits mais altos da altura
+    uint32_t dir;  // índice do filho direito + 3 bits mais baixos da altura
 } NO;
 
+// vetor contíguo com todos os nós da árvore
+NO *nos;
+uint32_t capacidade, usados;
+Indice livres = NULO;  // lista de nós removidos, encadeada pelo campo esq
+
 // Declaração antecipada da função buscarPorId
-NO* buscarPorId(NO *raiz, int id);
+Indice buscarPorId(Indice raiz, int id);
+
+// Funções de acesso às ligações compactadas
+Indice esq(Indice no) {
+    return nos[no].esq & MASCARA_INDICE;
+}
+
+Indice dir(Indice no) {
+    return nos[no].dir & MASCARA_INDICE;
+}
+
+void definirEsq(Indice no, Indice filho) {
+    nos[no].esq = (nos[no].esq & ~MASCARA_INDICE) | filho;
+}
+
+void definirDir(Indice no, Indice filho) {
+    nos[no].dir = (nos[no].dir & ~MASCARA_INDICE) | filho;
+}
+
+void definirAltura(Indice no, int altura) {
+    nos[no].esq = (nos[no].esq & MASCARA_INDICE) | ((uint32_t)(altura >> 3) << BITS_INDICE);
+    nos[no].dir = (nos[no].dir & MASCARA_INDICE) | ((uint32_t)(altura & 7) << BITS_INDICE);
+}
 
 // Função para calcular a altura de um nó
-int altura_NO(NO *no) {
-    if (no == NULL) return -1;
-    return no->altura;
+int altura_NO(Indice no) {
+    if (no == NULO) return -1;
+    return (int)(((nos[no].esq >> BITS_INDICE) << 3) | (nos[no].dir >> BITS_INDICE));
 }
 
 // Função que retorna o maior valor entre dois números
@@ -31,170 +68,200 @@ int maior(int a, int b) {
     return (a > b) ? a : b;
 }
 
+// Função para reservar um nó no vetor, reaproveitando nós removidos antes de crescer o vetor
+Indice alocarNO() {
+    if (livres != NULO) {
+        Indice no = livres;
+        livres = nos[no].esq;
+        return no;
+    }
+    if (usados == capacidade) {
+        uint32_t novaCapacidade = capacidade ? 2 * capacidade : 1024;
+        if (novaCapacidade > MAX_NOS) {
+            printf("\nLimite de usuarios atingido!\n");
+            exit(1);
+        }
+        NO *novoVetor = (NO*)realloc(nos, novaCapacidade * sizeof(NO));
+        if (novoVetor == NULL) {
+            printf("\nMemoria insuficiente!\n");
+            exit(1);
+        }
+        nos = novoVetor;
+        capacidade = novaCapacidade;
+        if (usados == 0) usados = 1;  // a posição 0 fica reservada para NULO
+    }
+    return usados++;
+}
+
+// Função para devolver um nó à lista de livres
+void liberarNO(Indice no) {
+    nos[no].esq = livres;
+    livres = no;
+}
+
 // Função para criar um novo nó e inicializá-lo
-NO* novoNO(Usuario u) {
-    NO* no = (NO*)malloc(sizeof(NO));
-    no->usuario = u;
-    no->altura = 0;
-    no->esq = NULL;
-    no->dir = NULL;
+Indice novoNO(Usuario u) {
+    Indice no = alocarNO();
+    nos[no].usuario = u;
+    nos[no].esq = NULO;
+    nos[no].dir = NULO;
+    definirAltura(no, 0);
     return no;
 }
 
 // Rotação à direita (caso de desequilíbrio do tipo "esquerda-esquerda")
-NO* rotacaoRR(NO *raiz) {
-    NO *no = raiz->dir;
-    raiz->dir = no->esq;
-    no->esq = raiz;
-    raiz->altura = maior(altura_NO(raiz->esq), altura_NO(raiz->dir)) + 1;
-    no->altura = maior(altura_NO(no->esq), altura_NO(no->dir)) + 1;
+Indice rotacaoRR(Indice raiz) {
+    Indice no = dir(raiz);
+    definirDir(raiz, esq(no));
+    definirEsq(no, raiz);
+    definirAltura(raiz, maior(altura_NO(esq(raiz)), altura_NO(dir(raiz))) + 1);
+    definirAltura(no, maior(altura_NO(esq(no)), altura_NO(dir(no))) + 1);
     return no;
 }
 
 // Rotação à esquerda (caso de desequilíbrio do tipo "direita-direita")
-NO* rotacaoLL(NO *raiz) {
-    NO *no = raiz->esq;
-    raiz->esq = no->dir;
-    no->dir = raiz;
-    raiz->altura = maior(altura_NO(raiz->esq), altura_NO(raiz->dir)) + 1;
-    no->altura = maior(altura_NO(no->esq), altura_NO(no->dir)) + 1;
+Indice rotacaoLL(Indice raiz) {
+    Indice no = esq(raiz);
+    definirEsq(raiz, dir(no));
+    definirDir(no, raiz);
+    definirAltura(raiz, maior(altura_NO(esq(raiz)), altura_NO(dir(raiz))) + 1);
+    definirAltura(no, maior(altura_NO(esq(no)), altura_NO(dir(no))) + 1);
     return no;
 }
 
 // Rotação esquerda-direita (caso de desequilíbrio do tipo "esquerda-direita")
-NO* rotacaoLR(NO *raiz) {
-    raiz->esq = rotacaoRR(raiz->esq);
+Indice rotacaoLR(Indice raiz) {
+    definirEsq(raiz, rotacaoRR(esq(raiz)));
     return rotacaoLL(raiz);
 }
 
 // Rotação direita-esquerda (caso de desequilíbrio do tipo "direita-esquerda")
-NO* rotacaoRL(NO *raiz) {
-    raiz->dir = rotacaoLL(raiz->dir);
+Indice rotacaoRL(Indice raiz) {
+    definirDir(raiz, rotacaoLL(dir(raiz)));
     return rotacaoRR(raiz);
 }
 
 // Função para calcular o fator de balanceamento de um nó
-int fatorBalanceamento(NO *no) {
-    if (no == NULL) return 0;
-    return altura_NO(no->esq) - altura_NO(no->dir);
+int fatorBalanceamento(Indice no) {
+    if (no == NULO) return 0;
+    return altura_NO(esq(no)) - altura_NO(dir(no));
 }
 
 // Função para inserir um usuário na árvore AVL
-NO* inserir(NO *raiz, Usuario u) {
-    if (raiz == NULL) return novoNO(u);
+Indice inserir(Indice raiz, Usuario u) {
+    if (raiz == NULO) return novoNO(u);
 
     // Verifica se o ID já existe
-    if (buscarPorId(raiz, u.id) != NULL) {
+    if (buscarPorId(raiz, u.id) != NULO) {
         printf("\nID ja cadastrado!\n");
         return raiz;  // Não insere o usuário se o ID já existir
     }
 
-    int cmp = strcmp(u.nome, raiz->usuario.nome);
+    int cmp = strcmp(u.nome, nos[raiz].usuario.nome);
     if (cmp < 0)
-        raiz->esq = inserir(raiz->esq, u);
+        definirEsq(raiz, inserir(esq(raiz), u));
     else if (cmp > 0)
-        raiz->dir = inserir(raiz->dir, u);
+        definirDir(raiz, inserir(dir(raiz), u));
     else {
         printf("\nNome ja cadastrado!\n");
         return raiz;  // Não insere o usuário se o nome já existir
     }
 
-    raiz->altura = maior(altura_NO(raiz->esq), altura_NO(raiz->dir)) + 1;
+    definirAltura(raiz, maior(altura_NO(esq(raiz)), altura_NO(dir(raiz))) + 1);
     int fb = fatorBalanceamento(raiz);
 
-    if (fb > 1 && strcmp(u.nome, raiz->esq->usuario.nome) < 0) return rotacaoLL(raiz);
-    if (fb < -1 && strcmp(u.nome, raiz->dir->usuario.nome) > 0) return rotacaoRR(raiz);
-    if (fb > 1 && strcmp(u.nome, raiz->esq->usuario.nome) > 0) return rotacaoLR(raiz);
-    if (fb < -1 && strcmp(u.nome, raiz->dir->usuario.nome) < 0) return rotacaoRL(raiz);
+    if (fb > 1 && strcmp(u.nome, nos[esq(raiz)].usuario.nome) < 0) return rotacaoLL(raiz);
+    if (fb < -1 && strcmp(u.nome, nos[dir(raiz)].usuario.nome) > 0) return rotacaoRR(raiz);
+    if (fb > 1 && strcmp(u.nome, nos[esq(raiz)].usuario.nome) > 0) return rotacaoLR(raiz);
+    if (fb < -1 && strcmp(u.nome, nos[dir(raiz)].usuario.nome) < 0) return rotacaoRL(raiz);
 
     return raiz;
 }
 
 // Função para buscar um usuário pelo ID
-NO* buscarPorId(NO *raiz, int id) {
-    if (raiz == NULL) return NULL;
-    if (id == raiz->usuario.id) return raiz;
-    if (id < raiz->usuario.id) return buscarPorId(raiz->esq, id);
-    return buscarPorId(raiz->dir, id);
+Indice buscarPorId(Indice raiz, int id) {
+    if (raiz == NULO) return NULO;
+    if (id == nos[raiz].usuario.id) return raiz;
+    if (id < nos[raiz].usuario.id) return buscarPorId(esq(raiz), id);
+    return buscarPorId(dir(raiz), id);
 }
 
 // Função para encontrar o nó com o menor valor
-NO* menorValor(NO* no) {
-    NO* atual = no;
-    while (atual->esq != NULL)
-        atual = atual->esq;
+Indice menorValor(Indice no) {
+    Indice atual = no;
+    while (esq(atual) != NULO)
+        atual = esq(atual);
     return atual;
 }
 
 // Função para remover um usuário da árvore AVL
-NO* remover(NO *raiz, char nome[]) {
-    if (raiz == NULL) return raiz;
+Indice remover(Indice raiz, char nome[]) {
+    if (raiz == NULO) return raiz;
 
-    int cmp = strcmp(nome, raiz->usuario.nome);
+    int cmp = strcmp(nome, nos[raiz].usuario.nome);
     if (cmp < 0)
-        raiz->esq = remover(raiz->esq, nome);
+        definirEsq(raiz, remover(esq(raiz), nome));
     else if (cmp > 0)
-        raiz->dir = remover(raiz->dir, nome);
+        definirDir(raiz, remover(dir(raiz), nome));
     else {
-        if (raiz->esq == NULL || raiz->dir == NULL) {
-            NO *temp = raiz->esq ? raiz->esq : raiz->dir;
-            if (temp == NULL) {
+        if (esq(raiz) == NULO || dir(raiz) == NULO) {
+            Indice temp = esq(raiz) ? esq(raiz) : dir(raiz);
+            if (temp == NULO) {
                 temp = raiz;
-                raiz = NULL;
+                raiz = NULO;
             } else {
-                *raiz = *temp;
+                nos[raiz] = nos[temp];
             }
-            free(temp);
+            liberarNO(temp);
         } else {
-            NO *temp = menorValor(raiz->dir);
-            raiz->usuario = temp->usuario;
-            raiz->dir = remover(raiz->dir, temp->usuario.nome);
+            Indice temp = menorValor(dir(raiz));
+            nos[raiz].usuario = nos[temp].usuario;
+            definirDir(raiz, remover(dir(raiz), nos[temp].usuario.nome));
         }
     }
 
-    if (raiz == NULL) return raiz;
+    if (raiz == NULO) return raiz;
 
-    raiz->altura = maior(altura_NO(raiz->esq), altura_NO(raiz->dir)) + 1;
+    definirAltura(raiz, maior(altura_NO(esq(raiz)), altura_NO(dir(raiz))) + 1);
     int fb = fatorBalanceamento(raiz);
 
-    if (fb > 1 && fatorBalanceamento(raiz->esq) >= 0) return rotacaoLL(raiz);
-    if (fb > 1 && fatorBalanceamento(raiz->esq) < 0) return rotacaoLR(raiz);
-    if (fb < -1 && fatorBalanceamento(raiz->dir) <= 0) return rotacaoRR(raiz);
-    if (fb < -1 && fatorBalanceamento(raiz->dir) > 0) return rotacaoRL(raiz);
+    if (fb > 1 && fatorBalanceamento(esq(raiz)) >= 0) return rotacaoLL(raiz);
+    if (fb > 1 && fatorBalanceamento(esq(raiz)) < 0) return rotacaoLR(raiz);
+    if (fb < -1 && fatorBalanceamento(dir(raiz)) <= 0) return rotacaoRR(raiz);
+    if (fb < -1 && fatorBalanceamento(dir(raiz)) > 0) return rotacaoRL(raiz);
 
     return raiz;
 }
 
 // Função para buscar um usuário pelo nome
-NO* buscar(NO *raiz, char nome[]) {
-    if (raiz == NULL) return NULL;
+Indice buscar(Indice raiz, char nome[]) {
+    if (raiz == NULO) return NULO;
 
-    int cmp = strcmp(nome, raiz->usuario.nome);
+    int cmp = strcmp(nome, nos[raiz].usuario.nome);
     if (cmp == 0) return raiz;
-    if (cmp < 0) return buscar(raiz->esq, nome);
-    return buscar(raiz->dir, nome);
+    if (cmp < 0) return buscar(esq(raiz), nome);
+    return buscar(dir(raiz), nome);
 }
 
 // Função para imprimir os usuários em ordem (ordem crescente pelo nome)
-void imprimirEmOrdem(NO *raiz) {
-    if (raiz != NULL) {
-        imprimirEmOrdem(raiz->esq);
-        printf("nome: %s | id: %d | email: %s\n", raiz->usuario.nome, raiz->usuario.id, raiz->usuario.email);
-        imprimirEmOrdem(raiz->dir);
+void imprimirEmOrdem(Indice raiz) {
+    if (raiz != NULO) {
+        imprimirEmOrdem(esq(raiz));
+        printf("nome: %s | id: %d | email: %s\n", nos[raiz].usuario.nome, nos[raiz].usuario.id, nos[raiz].usuario.email);
+        imprimirEmOrdem(dir(raiz));
     }
 }
 
-// Função para liberar a memória de todos os nós da árvore
-void liberarArvore(NO *raiz) {
-    if (raiz != NULL) {
-        liberarArvore(raiz->esq);
-        liberarArvore(raiz->dir);
-        free(raiz);
-    }
+// Função para liberar a memória de todos os nós da árvore (o vetor inteiro de uma vez)
+void liberarArvore() {
+    free(nos);
+    nos = NULL;
+    capacidade = usados = 0;
+    livres = NULO;
 }
 
 int main() {
-    NO *raiz = NULL;
+    Indice raiz = NULO;
     int opcao;
     do {
         printf("\nEscolha a opção desejada!!\n");
@@ -219,15 +286,15 @@ int main() {
             char nome[100];
             printf("Digite o NOME do usuario a buscar: ");
             fgets(nome, 100, stdin); nome[strcspn(nome, "\n")] = 0;
-            NO* encontrado = buscar(raiz, nome);
+            Indice encontrado = buscar(raiz, nome);
             if (encontrado)
-                printf("Usuario encontrado: nome: %s | id: %d | email: %s\n", encontrado->usuario.nome, encontrado->usuario.id, encontrado->usuario.email);
+                printf("Usuario encontrado: nome: %s | id: %d | email: %s\n", nos[encontrado].usuario.nome, nos[encontrado].usuario.id, nos[encontrado].usuario.email);
             else
                 printf("Usuario nao encontrado\n");
         }
 
     } while (opcao != 0);
 
-    liberarArvore(raiz);
+    liberarArvore();
     return 0;
 }
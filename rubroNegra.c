@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
 
 // Cores da árvore
 typedef enum { RED, BLACK } Color;
@@ -13,138 +16,241 @@ typedef struct Produto {
     float preco;
 } Produto;
 
-// Struct do nó que armazena o produto, a cor do nó e ponteiros importantes
+// Índice de um nó no vetor de nós (32 bits no lugar de um ponteiro de 64)
+typedef uint32_t Indice;
+
+// O bit mais alto do campo pai_cor guarda a cor; os 31 bits restantes guardam o índice do pai
+#define BIT_COR 0x80000000u
+#define MAX_NOS BIT_COR
+
+// Struct do nó que armazena o produto e os índices dos vizinhos, com a cor embutida no índice do pai
 typedef struct Node {
     Produto prod;
-    Color cor;
-    struct Node *esq, *dir, *pai;
+    Indice esq, dir;
+    uint32_t pai_cor;
 } Node;
 
-// Nó sentinela para representar NULL
-Node *NULL_LEAF;
+// Vetor contíguo com todos os nós da árvore
+Node *nos;
+uint32_t capacidade, usados;
+Indice livres;  // lista de nós removidos, encadeada pelo campo esq
+
+// Nó sentinela para representar NULL - sempre ocupa a posição 0 do vetor
+#define NULL_LEAF 0u
+
+Indice pai(Indice i) {
+    return nos[i].pai_cor & ~BIT_COR;
+}
+
+void definirPai(Indice i, Indice p) {
+    nos[i].pai_cor = (nos[i].pai_cor & BIT_COR) | p;
+}
 
-// Inicializar o nó sentinela
+Color cor(Indice i) {
+    return (nos[i].pai_cor & BIT_COR) ? BLACK : RED;
+}
+
+void definirCor(Indice i, Color c) {
+    if (c == BLACK) nos[i].pai_cor |= BIT_COR;
+    else nos[i].pai_cor &= ~BIT_COR;
+}
+
+// Inicializar o vetor de nós com o nó sentinela na posição 0
 void inicializarNullLeaf() {
-    NULL_LEAF = (Node*)malloc(sizeof(Node));
-    NULL_LEAF->cor = BLACK;
-    NULL_LEAF->esq = NULL_LEAF->dir = NULL_LEAF->pai = NULL_LEAF;
+    capacidade = 1024;
+    nos = (Node*)malloc(capacidade * sizeof(Node));
+    if (nos == NULL) {
+        printf("Erro: memória insuficiente!\n");
+        exit(1);
+    }
+    usados = 1;
+    livres = NULL_LEAF;
+    nos[NULL_LEAF].esq = nos[NULL_LEAF].dir = NULL_LEAF;
+    nos[NULL_LEAF].pai_cor = NULL_LEAF;
+    definirCor(NULL_LEAF, BLACK);
+}
+
+// Reserva um nó no vetor, reaproveitando nós removidos antes de crescer o vetor
+Indice alocarNo() {
+    if (livres != NULL_LEAF) {
+        Indice i = livres;
+        livres = nos[i].esq;
+        return i;
+    }
+    if (usados == capacidade) {
+        if (capacidade >= MAX_NOS) {
+            printf("Erro: limite de nós atingido!\n");
+            exit(1);
+        }
+        Node* novoVetor = (Node*)realloc(nos, 2 * capacidade * sizeof(Node));
+        if (novoVetor == NULL) {
+            printf("Erro: memória insuficiente!\n");
+            exit(1);
+        }
+        nos = novoVetor;
+        capacidade *= 2;
+    }
+    return usados++;
+}
+
+// Devolve um nó para a lista de livres
+void liberarNo(Indice i) {
+    nos[i].esq = livres;
+    livres = i;
 }
 
 // Criando novo produto
-Node* criarNoProduto(int codigo, char* nome, int qtd, float preco) {
-    Node* novo = (Node*)malloc(sizeof(Node));
-    novo->prod.codigo = codigo;
-    strcpy(novo->prod.nome, nome);
-    novo->prod.quantidade = qtd;
-    novo->prod.preco = preco;
-    novo->cor = RED;  // Novo nó sempre começa como RED (propriedade da Red-Black Tree)
-    novo->esq = novo->dir = NULL_LEAF;
-    novo->pai = NULL_LEAF;
+Indice criarNoProduto(int codigo, char* nome, int qtd, float preco) {
+    Indice novo = alocarNo();
+    nos[novo].prod.codigo = codigo;
+    strcpy(nos[novo].prod.nome, nome);
+    nos[novo].prod.quantidade = qtd;
+    nos[novo].prod.preco = preco;
+    nos[novo].esq = nos[novo].dir = NULL_LEAF;
+    nos[novo].pai_cor = NULL_LEAF;
+    definirCor(novo, RED);  // Novo nó sempre começa como RED (propriedade da Red-Black Tree)
     return novo;
 }
 
 // Rotação para a esquerda - crucial para manter o balanceamento da árvore
-Node* rotacaoEsquerda(Node* raiz, Node* x) {
-    Node* y = x->dir;
-    x->dir = y->esq;
-    if (y->esq != NULL_LEAF) y->esq->pai = x;
-    y->pai = x->pai;
-    if (x->pai == NULL_LEAF) raiz = y;
-    else if (x == x->pai->esq) x->pai->esq = y;
-    else x->pai->dir = y;
-    y->esq = x;
-    x->pai = y;
+Indice rotacaoEsquerda(Indice raiz, Indice x) {
+    Indice y = nos[x].dir;
+    nos[x].dir = nos[y].esq;
+    if (nos[y].esq != NULL_LEAF) definirPai(nos[y].esq, x);
+    definirPai(y, pai(x));
+    if (pai(x) == NULL_LEAF) raiz = y;
+    else if (x == nos[pai(x)].esq) nos[pai(x)].esq = y;
+    else nos[pai(x)].dir = y;
+    nos[y].esq = x;
+    definirPai(x, y);
     return raiz;
 }
 
 // Rotação para a direita - crucial para manter o balanceamento da árvore
-Node* rotacaoDireita(Node* raiz, Node* y) {
-    Node* x = y->esq;
-    y->esq = x->dir;
-    if (x->dir != NULL_LEAF) x->dir->pai = y;
-    x->pai = y->pai;
-    if (y->pai == NULL_LEAF) raiz = x;
-    else if (y == y->pai->dir) y->pai->dir = x;
-    else y->pai->esq = x;
-    x->dir = y;
-    y->pai = x;
+Indice rotacaoDireita(Indice raiz, Indice y) {
+    Indice x = nos[y].esq;
+    nos[y].esq = nos[x].dir;
+    if (nos[x].dir != NULL_LEAF) definirPai(nos[x].dir, y);
+    definirPai(x, pai(y));
+    if (pai(y) == NULL_LEAF) raiz = x;
+    else if (y == nos[pai(y)].dir) nos[pai(y)].dir = x;
+    else nos[pai(y)].esq = x;
+    nos[x].dir = y;
+    definirPai(y, x);
     return raiz;
 }
 
 // Inserção BST padrão - mantém a propriedade de busca binária
-Node* inserirBST(Node* raiz, Node* novo) {
+Indice inserirBST(Indice raiz, Indice novo) {
     if (raiz == NULL_LEAF) return novo;
-    if (novo->prod.codigo < raiz->prod.codigo) {
-        raiz->esq = inserirBST(raiz->esq, novo);
-        raiz->esq->pai = raiz;
-    } else if (novo->prod.codigo > raiz->prod.codigo) {
-        raiz->dir = inserirBST(raiz->dir, novo);
-        raiz->dir->pai = raiz;
+    if (nos[novo].prod.codigo < nos[raiz].prod.codigo) {
+        nos[raiz].esq = inserirBST(nos[raiz].esq, novo);
+        definirPai(nos[raiz].esq, raiz);
+    } else if (nos[novo].prod.codigo > nos[raiz].prod.codigo) {
+        nos[raiz].dir = inserirBST(nos[raiz].dir, novo);
+        definirPai(nos[raiz].dir, raiz);
     }
     return raiz;
 }
 
 // Função mais complexa - corrige as violações das propriedades da Red-Black Tree após inserção
-Node* corrigirInsercao(Node* raiz, Node* no) {
-    Node* tio;
-    while (no != raiz && no->pai->cor == RED) {
-        if (no->pai == no->pai->pai->esq) {
-            tio = no->pai->pai->dir;
-            if (tio->cor == RED) {
+Indice corrigirInsercao(Indice raiz, Indice no) {
+    Indice tio;
+    while (no != raiz && cor(pai(no)) == RED) {
+        if (pai(no) == nos[pai(pai(no))].esq) {
+            tio = nos[pai(pai(no))].dir;
+            if (cor(tio) == RED) {
                 // Caso 1: tio vermelho - recolorir
-                no->pai->cor = BLACK;
-                tio->cor = BLACK;
-                no->pai->pai->cor = RED;
-                no = no->pai->pai;
+                definirCor(pai(no), BLACK);
+                definirCor(tio, BLACK);
+                definirCor(pai(pai(no)), RED);
+                no = pai(pai(no));
             } else {
-                if (no == no->pai->dir) {
+                if (no == nos[pai(no)].dir) {
                     // Caso 2: tio preto e nó é filho direito - transformar em caso 3
-                    no = no->pai;
+                    no = pai(no);
                     raiz = rotacaoEsquerda(raiz, no);
                 }
                 // Caso 3: tio preto e nó é filho esquerdo - recolorir e rotacionar
-                no->pai->cor = BLACK;
-                no->pai->pai->cor = RED;
-                raiz = rotacaoDireita(raiz, no->pai->pai);
+                definirCor(pai(no), BLACK);
+                definirCor(pai(pai(no)), RED);
+                raiz = rotacaoDireita(raiz, pai(pai(no)));
             }
         } else {
             // Casos espelhados para quando o pai é filho direito
-            tio = no->pai->pai->esq;
-            if (tio->cor == RED) {
-                no->pai->cor = BLACK;
-                tio->cor = BLACK;
-                no->pai->pai->cor = RED;
-                no = no->pai->pai;
+            tio = nos[pai(pai(no))].esq;
+            if (cor(tio) == RED) {
+                definirCor(pai(no), BLACK);
+                definirCor(tio, BLACK);
+                definirCor(pai(pai(no)), RED);
+                no = pai(pai(no));
             } else {
-                if (no == no->pai->esq) {
-                    no = no->pai;
+                if (no == nos[pai(no)].esq) {
+                    no = pai(no);
                     raiz = rotacaoDireita(raiz, no);
                 }
-                no->pai->cor = BLACK;
-                no->pai->pai->cor = RED;
-                raiz = rotacaoEsquerda(raiz, no->pai->pai);
+                definirCor(pai(no), BLACK);
+                definirCor(pai(pai(no)), RED);
+                raiz = rotacaoEsquerda(raiz, pai(pai(no)));
             }
         }
     }
-    raiz->cor = BLACK;  // Garante que a raiz sempre seja preta
+    definirCor(raiz, BLACK);  // Garante que a raiz sempre seja preta
     return raiz;
 }
 
-Node* buscar(Node* raiz, int codigo) {
-    if (raiz == NULL_LEAF || raiz->prod.codigo == codigo)
+Indice buscar(Indice raiz, int codigo) {
+    if (raiz == NULL_LEAF || nos[raiz].prod.codigo == codigo)
         return raiz;
-    if (codigo < raiz->prod.codigo)
-        return buscar(raiz->esq, codigo);
+    if (codigo < nos[raiz].prod.codigo)
+        return buscar(nos[raiz].esq, codigo);
     else
-        return buscar(raiz->dir, codigo);
+        return buscar(nos[raiz].dir, codigo);
+}
+
+// Prefetch de software: pede a linha de cache do nó antes de ele ser lido
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(endereco) __builtin_prefetch(endereco)
+#else
+#define PREFETCH(endereco) ((void)0)
+#endif
+
+// Quantidade de buscas que avançam juntas em cada grupo
+#define TAMANHO_GRUPO 16
+
+// Busca vários códigos de uma vez - as buscas de um grupo descem a árvore em paralelo, um nível
+// por rodada, e o próximo nó de cada uma é pedido com prefetch, então as faltas de cache das
+// buscas independentes se sobrepõem em vez de acontecerem uma depois da outra
+void buscarLote(Indice raiz, int* codigos, Indice* resultados, int n) {
+    for (int inicio = 0; inicio < n; inicio += TAMANHO_GRUPO) {
+        int fim = (inicio + TAMANHO_GRUPO < n) ? inicio + TAMANHO_GRUPO : n;
+        for (int i = inicio; i < fim; i++)
+            resultados[i] = raiz;
+
+        int ativas = fim - inicio;
+        while (ativas > 0) {
+            ativas = 0;
+            for (int i = inicio; i < fim; i++) {
+                Indice atual = resultados[i];
+                if (atual == NULL_LEAF || nos[atual].prod.codigo == codigos[i])
+                    continue;
+                atual = (codigos[i] < nos[atual].prod.codigo) ? nos[atual].esq : nos[atual].dir;
+                // O código fica no início do nó e os índices dos filhos no fim - o nó pode ocupar duas linhas
+                PREFETCH(&nos[atual].prod.codigo);
+                PREFETCH(&nos[atual].esq);
+                resultados[i] = atual;
+                ativas++;
+            }
+        }
+    }
 }
 
-Node* inserir(Node* raiz, int cod, char* nome, int qtd, float preco) {
-    Node* novo = criarNoProduto(cod, nome, qtd, preco);
+Indice inserir(Indice raiz, int cod, char* nome, int qtd, float preco) {
+    Indice novo = criarNoProduto(cod, nome, qtd, preco);
 
     if (buscar(raiz, cod) != NULL_LEAF) {
         printf("Erro: Produto com código %d já existe!\n", cod);
-        free(novo);
+        liberarNo(novo);
         return raiz;
     } else {
         printf("Produto inserido com sucesso!\n");
@@ -154,206 +260,206 @@ Node* inserir(Node* raiz, int cod, char* nome, int qtd, float preco) {
     return corrigirInsercao(raiz, novo);
 }
 
-void emOrdem(Node* raiz) {
+void emOrdem(Indice raiz) {
     if (raiz == NULL_LEAF) return;
 
-    emOrdem(raiz->esq);
+    emOrdem(nos[raiz].esq);
 
     printf("Código: %d (%s), Nome: %s, Qtd: %d, Preço: %.2f",
-           raiz->prod.codigo,
-           raiz->cor == RED ? "R" : "B",
-           raiz->prod.nome,
-           raiz->prod.quantidade,
-           raiz->prod.preco);
+           nos[raiz].prod.codigo,
+           cor(raiz) == RED ? "R" : "B",
+           nos[raiz].prod.nome,
+           nos[raiz].prod.quantidade,
+           nos[raiz].prod.preco);
 
-    if (raiz->pai == NULL_LEAF) {
+    if (pai(raiz) == NULL_LEAF) {
         printf(" [RAIZ]");
     }
 
     printf("\n");
 
-    emOrdem(raiz->dir);
+    emOrdem(nos[raiz].dir);
 }
 
 // Função auxiliar para substituir uma subárvore por outra
-void transplantar(Node** raiz, Node* u, Node* v) {
-    if (u->pai == NULL_LEAF)
+void transplantar(Indice* raiz, Indice u, Indice v) {
+    if (pai(u) == NULL_LEAF)
         *raiz = v;
-    else if (u == u->pai->esq)
-        u->pai->esq = v;
+    else if (u == nos[pai(u)].esq)
+        nos[pai(u)].esq = v;
     else
-        u->pai->dir = v;
+        nos[pai(u)].dir = v;
 
-    v->pai = u->pai;
+    definirPai(v, pai(u));
 }
 
 // Encontra o nó com menor valor na subárvore
-Node* minimo(Node* no) {
-    while (no->esq != NULL_LEAF)
-        no = no->esq;
+Indice minimo(Indice no) {
+    while (nos[no].esq != NULL_LEAF)
+        no = nos[no].esq;
     return no;
 }
 
 // Verifica as propriedades da Red-Black Tree - útil para debug
-void verificarArvore(Node* raiz) {
+void verificarArvore(Indice raiz) {
     if (raiz == NULL_LEAF) return;
     
     // Propriedade 2: A raiz é preta
-    if (raiz->pai == NULL_LEAF && raiz->cor != BLACK) {
+    if (pai(raiz) == NULL_LEAF && cor(raiz) != BLACK) {
         printf("ERRO: Raiz não é preta!\n");
     }
     
     // Propriedade 3: Nenhum nó vermelho tem filho vermelho
-    if (raiz->cor == RED) {
-        if (raiz->esq != NULL_LEAF && raiz->esq->cor == RED) {
-            printf("ERRO: Nó %d vermelho com filho esquerdo vermelho!\n", raiz->prod.codigo);
+    if (cor(raiz) == RED) {
+        if (nos[raiz].esq != NULL_LEAF && cor(nos[raiz].esq) == RED) {
+            printf("ERRO: Nó %d vermelho com filho esquerdo vermelho!\n", nos[raiz].prod.codigo);
         }
-        if (raiz->dir != NULL_LEAF && raiz->dir->cor == RED) {
-            printf("ERRO: Nó %d vermelho com filho direito vermelho!\n", raiz->prod.codigo);
+        if (nos[raiz].dir != NULL_LEAF && cor(nos[raiz].dir) == RED) {
+            printf("ERRO: Nó %d vermelho com filho direito vermelho!\n", nos[raiz].prod.codigo);
         }
     }
     
-    verificarArvore(raiz->esq);
-    verificarArvore(raiz->dir);
+    verificarArvore(nos[raiz].esq);
+    verificarArvore(nos[raiz].dir);
 }
 
 // Função mais complexa - corrige as violações das propriedades da Red-Black Tree após remoção
-Node* corrigirRemocao(Node* raiz, Node* x) {
-    while (x != raiz && x->cor == BLACK) {
-        if (x == x->pai->esq) {
-            Node* w = x->pai->dir;
-            if (w->cor == RED) {
+Indice corrigirRemocao(Indice raiz, Indice x) {
+    while (x != raiz && cor(x) == BLACK) {
+        if (x == nos[pai(x)].esq) {
+            Indice w = nos[pai(x)].dir;
+            if (cor(w) == RED) {
                 // Caso 1: irmão w é vermelho - transformar em caso 2, 3 ou 4
-                w->cor = BLACK;
-                x->pai->cor = RED;
-                raiz = rotacaoEsquerda(raiz, x->pai);
-                w = x->pai->dir;
+                definirCor(w, BLACK);
+                definirCor(pai(x), RED);
+                raiz = rotacaoEsquerda(raiz, pai(x));
+                w = nos[pai(x)].dir;
             }
 
-            if (w->esq->cor == BLACK && w->dir->cor == BLACK) {
+            if (cor(nos[w].esq) == BLACK && cor(nos[w].dir) == BLACK) {
                 // Caso 2: irmão w é preto e ambos os filhos são pretos
-                w->cor = RED;
-                x = x->pai;
+                definirCor(w, RED);
+                x = pai(x);
             } else {
-                if (w->dir->cor == BLACK) {
+                if (cor(nos[w].dir) == BLACK) {
                     // Caso 3: irmão w é preto, filho esquerdo é vermelho, direito é preto
-                    w->esq->cor = BLACK;
-                    w->cor = RED;
+                    definirCor(nos[w].esq, BLACK);
+                    definirCor(w, RED);
                     raiz = rotacaoDireita(raiz, w);
-                    w = x->pai->dir;
+                    w = nos[pai(x)].dir;
                 }
                 // Caso 4: irmão w é preto, filho direito é vermelho
-                w->cor = x->pai->cor;
-                x->pai->cor = BLACK;
-                w->dir->cor = BLACK;
-                raiz = rotacaoEsquerda(raiz, x->pai);
+                definirCor(w, cor(pai(x)));
+                definirCor(pai(x), BLACK);
+                definirCor(nos[w].dir, BLACK);
+                raiz = rotacaoEsquerda(raiz, pai(x));
                 x = raiz;
             }
         } else {
             // Casos espelhados para quando x é filho direito
-            Node* w = x->pai->esq;
-            if (w->cor == RED) {
-                w->cor = BLACK;
-                x->pai->cor = RED;
-                raiz = rotacaoDireita(raiz, x->pai);
-                w = x->pai->esq;
+            Indice w = nos[pai(x)].esq;
+            if (cor(w) == RED) {
+                definirCor(w, BLACK);
+                definirCor(pai(x), RED);
+                raiz = rotacaoDireita(raiz, pai(x));
+                w = nos[pai(x)].esq;
             }
 
-            if (w->dir->cor == BLACK && w->esq->cor == BLACK) {
-                w->cor = RED;
-                x = x->pai;
+            if (cor(nos[w].dir) == BLACK && cor(nos[w].esq) == BLACK) {
+                definirCor(w, RED);
+                x = pai(x);
             } else {
-                if (w->esq->cor == BLACK) {
-                    w->dir->cor = BLACK;
-                    w->cor = RED;
+                if (cor(nos[w].esq) == BLACK) {
+                    definirCor(nos[w].dir, BLACK);
+                    definirCor(w, RED);
                     raiz = rotacaoEsquerda(raiz, w);
-                    w = x->pai->esq;
+                    w = nos[pai(x)].esq;
                 }
-                w->cor = x->pai->cor;
-                x->pai->cor = BLACK;
-                w->esq->cor = BLACK;
-                raiz = rotacaoDireita(raiz, x->pai);
+                definirCor(w, cor(pai(x)));
+                definirCor(pai(x), BLACK);
+                definirCor(nos[w].esq, BLACK);
+                raiz = rotacaoDireita(raiz, pai(x));
                 x = raiz;
             }
         }
     }
-    x->cor = BLACK;
+    definirCor(x, BLACK);
     return raiz;
 }
 
-Node* remover(Node* raiz, int codigo) {
+Indice remover(Indice raiz, int codigo) {
     if (raiz == NULL_LEAF) {
         printf("A árvore está vazia!\n");
         return raiz;
     }
 
-    Node* z = buscar(raiz, codigo);
+    Indice z = buscar(raiz, codigo);
     if (z == NULL_LEAF) {
         printf("Produto com código %d não encontrado!\n", codigo);
         return raiz;
     }
 
     // Verifica se é o caso especial (3 nós no total e removendo a raiz)
-    int nos_esq = (raiz->esq != NULL_LEAF);
-    int nos_dir = (raiz->dir != NULL_LEAF);
+    int nos_esq = (nos[raiz].esq != NULL_LEAF);
+    int nos_dir = (nos[raiz].dir != NULL_LEAF);
     int total_nos = 1 + nos_esq + nos_dir;
 
     if (total_nos == 3 && z == raiz) {
         // Tratamento especial para manter a árvore balanceada neste caso específico
-        Node* novo_raiz;
-        Node* outro_no;
+        Indice novo_raiz;
+        Indice outro_no;
         
-        if (raiz->esq != NULL_LEAF && raiz->dir != NULL_LEAF) {
-            novo_raiz = (raiz->esq->prod.codigo < raiz->dir->prod.codigo) ? raiz->esq : raiz->dir;
-            outro_no = (novo_raiz == raiz->esq) ? raiz->dir : raiz->esq;
+        if (nos[raiz].esq != NULL_LEAF && nos[raiz].dir != NULL_LEAF) {
+            novo_raiz = (nos[nos[raiz].esq].prod.codigo < nos[nos[raiz].dir].prod.codigo) ? nos[raiz].esq : nos[raiz].dir;
+            outro_no = (novo_raiz == nos[raiz].esq) ? nos[raiz].dir : nos[raiz].esq;
         } else {
-            novo_raiz = (raiz->esq != NULL_LEAF) ? raiz->esq : raiz->dir;
+            novo_raiz = (nos[raiz].esq != NULL_LEAF) ? nos[raiz].esq : nos[raiz].dir;
             outro_no = NULL_LEAF;
         }
 
-        novo_raiz->pai = NULL_LEAF;
-        novo_raiz->cor = BLACK;
+        definirPai(novo_raiz, NULL_LEAF);
+        definirCor(novo_raiz, BLACK);
         
         if (outro_no != NULL_LEAF) {
-            novo_raiz->dir = outro_no;
-            outro_no->pai = novo_raiz;
-            outro_no->cor = RED;
-            novo_raiz->esq = NULL_LEAF;
+            nos[novo_raiz].dir = outro_no;
+            definirPai(outro_no, novo_raiz);
+            definirCor(outro_no, RED);
+            nos[novo_raiz].esq = NULL_LEAF;
         }
 
-        free(raiz);
+        liberarNo(raiz);
         return novo_raiz;
     }
 
     // Algoritmo padrão de remoção em Red-Black Tree
-    Node* y = z;
-    Node* x;
-    Color corOriginal = y->cor;
-
-    if (z->esq == NULL_LEAF) {
-        x = z->dir;
-        transplantar(&raiz, z, z->dir);
-    } else if (z->dir == NULL_LEAF) {
-        x = z->esq;
-        transplantar(&raiz, z, z->esq);
+    Indice y = z;
+    Indice x;
+    Color corOriginal = cor(y);
+
+    if (nos[z].esq == NULL_LEAF) {
+        x = nos[z].dir;
+        transplantar(&raiz, z, nos[z].dir);
+    } else if (nos[z].dir == NULL_LEAF) {
+        x = nos[z].esq;
+        transplantar(&raiz, z, nos[z].esq);
     } else {
-        y = minimo(z->dir);
-        corOriginal = y->cor;
-        x = y->dir;
-        if (y->pai == z) {
-            x->pai = y;
+        y = minimo(nos[z].dir);
+        corOriginal = cor(y);
+        x = nos[y].dir;
+        if (pai(y) == z) {
+            definirPai(x, y);
         } else {
-            transplantar(&raiz, y, y->dir);
-            y->dir = z->dir;
-            y->dir->pai = y;
+            transplantar(&raiz, y, nos[y].dir);
+            nos[y].dir = nos[z].dir;
+            definirPai(nos[y].dir, y);
         }
         transplantar(&raiz, z, y);
-        y->esq = z->esq;
-        y->esq->pai = y;
-        y->cor = z->cor;
+        nos[y].esq = nos[z].esq;
+        definirPai(nos[y].esq, y);
+        definirCor(y, cor(z));
     }
 
-    free(z);
+    liberarNo(z);
     printf("Produto removido com sucesso!\n");
 
     if (corOriginal == BLACK)
@@ -362,6 +468,90 @@ Node* remover(Node* raiz, int codigo) {
     return raiz;
 }
 
+#ifdef BENCH
+// Benchmark de buscar contra buscarLote - metade das chaves existe na árvore e metade não
+int main(int argc, char* argv[]) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int consultas = (argc > 2) ? atoi(argv[2]) : 2000000;
+    unsigned int semente = 12345;
+
+    // Os códigos vão até 2n-1, então n precisa caber em int mesmo dobrado
+    if (n <= 0 || consultas <= 0 || n > INT_MAX / 2) {
+        printf("Uso: %s [nos] [consultas]\n", argv[0]);
+        printf("nos deve estar entre 1 e %d e consultas deve ser maior que 0.\n", INT_MAX / 2);
+        return 1;
+    }
+
+    inicializarNullLeaf();
+    Indice raiz = NULL_LEAF;
+
+    // Embaralha os códigos pares 0, 2, ..., 2n-2 para inserir em ordem aleatória
+    int* pares = (int*)malloc((size_t)n * sizeof(int));
+    if (pares == NULL) {
+        printf("Erro: memória insuficiente!\n");
+        return 1;
+    }
+    for (int i = 0; i < n; i++)
+        pares[i] = 2 * i;
+    for (int i = n - 1; i > 0; i--) {
+        semente = semente * 1103515245u + 12345u;
+        int j = (int)((semente >> 1) % (unsigned int)(i + 1));
+        int temp = pares[i];
+        pares[i] = pares[j];
+        pares[j] = temp;
+    }
+
+    // Monta a árvore sem passar pelas mensagens de inserir
+    for (int i = 0; i < n; i++) {
+        Indice novo = criarNoProduto(pares[i], "produto", 1, 1.0f);
+        raiz = inserirBST(raiz, novo);
+        raiz = corrigirInsercao(raiz, novo);
+    }
+    free(pares);
+
+    int* codigos = (int*)malloc((size_t)consultas * sizeof(int));
+    Indice* esperados = (Indice*)malloc((size_t)consultas * sizeof(Indice));
+    Indice* resultados = (Indice*)malloc((size_t)consultas * sizeof(Indice));
+    if (codigos == NULL || esperados == NULL || resultados == NULL) {
+        printf("Erro: memória insuficiente!\n");
+        return 1;
+    }
+
+    // Códigos pares podem existir, ímpares nunca existem
+    for (int i = 0; i < consultas; i++) {
+        semente = semente * 1103515245u + 12345u;
+        codigos[i] = (int)((semente >> 1) % (unsigned int)(2 * n));
+    }
+
+    clock_t inicio = clock();
+    for (int i = 0; i < consultas; i++)
+        esperados[i] = buscar(raiz, codigos[i]);
+    clock_t meio = clock();
+    buscarLote(raiz, codigos, resultados, consultas);
+    clock_t fim = clock();
+
+    int encontrados = 0;
+    for (int i = 0; i < consultas; i++) {
+        if (resultados[i] != esperados[i]) {
+            printf("ERRO: resultado diferente para o código %d!\n", codigos[i]);
+            return 1;
+        }
+        if (resultados[i] != NULL_LEAF) encontrados++;
+    }
+
+    double tempoBuscar = (double)(meio - inicio) / CLOCKS_PER_SEC;
+    double tempoLote = (double)(fim - meio) / CLOCKS_PER_SEC;
+    printf("Nós: %d, consultas: %d (%d encontradas)\n", n, consultas, encontrados);
+    printf("buscar:     %.1f ns por código\n", tempoBuscar / consultas * 1e9);
+    printf("buscarLote: %.1f ns por código\n", tempoLote / consultas * 1e9);
+    printf("Ganho: %.2fx\n", tempoBuscar / tempoLote);
+
+    free(codigos);
+    free(esperados);
+    free(resultados);
+    return 0;
+}
+#else
 // Função principal com menu
 int main() {
     system("chcp 65001");
@@ -370,7 +560,7 @@ int main() {
     // Inicializar o nó sentinela
     inicializarNullLeaf();
     
-    Node* raiz = NULL_LEAF;
+    Indice raiz = NULL_LEAF;
     int opcao, cod, qtd;
     float preco;
     char nome[50];
@@ -381,6 +571,7 @@ int main() {
         printf("2 - Remover Produto\n");
         printf("3 - Buscar Produto\n");
         printf("4 - Listar Produtos\n");
+        printf("5 - Buscar Vários Produtos\n");
         printf("0 - Sair\n");
         printf("Escolha uma opção: ");
         scanf("%d", &opcao);
@@ -409,11 +600,11 @@ int main() {
             case 3: {
                 printf("Código do produto a buscar: ");
                 scanf("%d", &cod);
-                Node* encontrado = buscar(raiz, cod);
+                Indice encontrado = buscar(raiz, cod);
                 if (encontrado != NULL_LEAF) {
                     printf("Produto encontrado: Código: %d, Nome: %s, Qtd: %d, Preço: %.2f\n",
-                           encontrado->prod.codigo, encontrado->prod.nome,
-                           encontrado->prod.quantidade, encontrado->prod.preco);
+                           nos[encontrado].prod.codigo, nos[encontrado].prod.nome,
+                           nos[encontrado].prod.quantidade, nos[encontrado].prod.preco);
                 } else {
                     printf("Produto não encontrado.\n");
                 }
@@ -429,6 +620,40 @@ int main() {
                 }
                 break;
 
+            case 5: {
+                int n;
+                printf("Quantidade de códigos: ");
+                scanf("%d", &n);
+                if (n <= 0) {
+                    printf("Quantidade inválida!\n");
+                    break;
+                }
+                int* codigos = (int*)malloc((size_t)n * sizeof(int));
+                Indice* encontrados = (Indice*)malloc((size_t)n * sizeof(Indice));
+                if (codigos == NULL || encontrados == NULL) {
+                    printf("Erro: memória insuficiente!\n");
+                    free(codigos);
+                    free(encontrados);
+                    break;
+                }
+                printf("Códigos dos produtos a buscar: ");
+                for (int i = 0; i < n; i++)
+                    scanf("%d", &codigos[i]);
+                buscarLote(raiz, codigos, encontrados, n);
+                for (int i = 0; i < n; i++) {
+                    if (encontrados[i] != NULL_LEAF) {
+                        printf("Produto encontrado: Código: %d, Nome: %s, Qtd: %d, Preço: %.2f\n",
+                               nos[encontrados[i]].prod.codigo, nos[encontrados[i]].prod.nome,
+                               nos[encontrados[i]].prod.quantidade, nos[encontrados[i]].prod.preco);
+                    } else {
+                        printf("Produto com código %d não encontrado.\n", codigos[i]);
+                    }
+                }
+                free(codigos);
+                free(encontrados);
+                break;
+            }
+
             case 0:
                 printf("Encerrando programa...\n");
                 break;
@@ -440,4 +665,5 @@ int main() {
     } while (opcao != 0);
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file